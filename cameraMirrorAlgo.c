@@ -5,62 +5,620 @@ Alg_CameraMirror_Obj * Alg_CameraMirrorCreate(
  Alg_CameraMirror_Obj * pAlgHandle;
  pAlgHandle = (Alg_CameraMirror_Obj *) malloc(sizeof(Alg_CameraMirror_Obj));
  UTILS_assert(pAlgHandle != NULL);
+ memset(&pAlgHandle->controlParams, 0, sizeof(Alg_CameraMirrorControlParams));
  return pAlgHandle;
 }
 
-Int32 Alg_CameraMirrorProcess(Alg_CameraMirror_Obj *algHandle,
- UInt32 *inPtr[],
-UInt32 width,
-UInt32 height,
-UInt32 inPitch[],
-UInt32 dataFormat
- )
+static Void Alg_CameraMirrorSwapRows(const Alg_CameraMirrorPlaneInfo *pPlane,
+ UInt32 *planePtr)
 {
- Int32 rowIdx;
- Int32 colIdx;
- UInt32 wordWidth;
-
+ UInt32 rowIdx;
+ UInt32 colIdx;
  UInt32 *inputPtr;
- /* Uncomment the variables below. */
  UInt32 *outputPtr;
  UInt32 temp;
 
+ inputPtr = planePtr;
+ outputPtr = planePtr + pPlane->lastRowOffset;
+ for(rowIdx = 0; rowIdx < pPlane->numRowPairs; rowIdx++)
+ {
+ 	for(colIdx = 0; colIdx < pPlane->wordWidth; colIdx++)
+ 	{
+ 		temp = *(inputPtr + colIdx);
+ 		*(inputPtr + colIdx) = *(outputPtr + colIdx);
+ 		*(outputPtr + colIdx) = temp;
+ 	}
+
+ inputPtr += pPlane->wordPitch;
+ outputPtr -= pPlane->wordPitch;
+ }
+}
+
+/* Same as Alg_CameraMirrorSwapRows, for rows with an even number of words */
+static Void Alg_CameraMirrorSwapRowsX2(const Alg_CameraMirrorPlaneInfo *pPlane,
+ UInt32 *planePtr)
+{
+ UInt32 rowIdx;
+ UInt32 colIdx;
+ UInt32 *inputPtr;
+ UInt32 *outputPtr;
+ UInt32 temp0;
+ UInt32 temp1;
+
+ inputPtr = planePtr;
+ outputPtr = planePtr + pPlane->lastRowOffset;
+ for(rowIdx = 0; rowIdx < pPlane->numRowPairs; rowIdx++)
+ {
+ 	for(colIdx = 0; colIdx < pPlane->wordWidth; colIdx += 2)
+ 	{
+ 		temp0 = *(inputPtr + colIdx);
+ 		temp1 = *(inputPtr + colIdx + 1);
+ 		*(inputPtr + colIdx) = *(outputPtr + colIdx);
+ 		*(inputPtr + colIdx + 1) = *(outputPtr + colIdx + 1);
+ 		*(outputPtr + colIdx) = temp0;
+ 		*(outputPtr + colIdx + 1) = temp1;
+ 	}
+
+ inputPtr += pPlane->wordPitch;
+ outputPtr -= pPlane->wordPitch;
+ }
+}
+
+/*
+ * Out of place kernels, output row r is taken from source row
+ * (lastRow - r * srcRowStep), i.e. the tile gets the vertically mirrored frame
+ */
+static Void Alg_CameraMirrorCopyRows(const Alg_CameraMirrorPlaneInfo *pPlane,
+ const UInt32 *srcPtr,
+ UInt32 *dstPtr)
+{
+ UInt32 rowIdx;
+ UInt32 colIdx;
+ const UInt32 *inputPtr;
+ UInt32 *outputPtr;
+
+ inputPtr = srcPtr + pPlane->lastRowOffset;
+ outputPtr = dstPtr + pPlane->dstOffset;
+ for(rowIdx = 0; rowIdx < pPlane->numOutRows; rowIdx++)
+ {
+ 	for(colIdx = 0; colIdx < pPlane->wordWidth; colIdx++)
+ 	{
+ 		*(outputPtr + colIdx) = *(inputPtr + colIdx);
+ 	}
+
+ inputPtr -= pPlane->srcRowStep;
+ outputPtr += pPlane->dstWordPitch;
+ }
+}
+
+/* 2x decimation of YUYV, keeps Y0 U V of even macro pixels and Y0 of odd ones */
+static Void Alg_CameraMirrorCopyRowsDecYuyv(const Alg_CameraMirrorPlaneInfo *pPlane,
+ const UInt32 *srcPtr,
+ UInt32 *dstPtr)
+{
+ UInt32 rowIdx;
+ UInt32 colIdx;
+ const UInt32 *inputPtr;
+ UInt32 *outputPtr;
+
+ inputPtr = srcPtr + pPlane->lastRowOffset;
+ outputPtr = dstPtr + pPlane->dstOffset;
+ for(rowIdx = 0; rowIdx < pPlane->numOutRows; rowIdx++)
+ {
+ 	for(colIdx = 0; colIdx < pPlane->wordWidth; colIdx++)
+ 	{
+ 		*(outputPtr + colIdx) = (*(inputPtr + 2*colIdx) & 0xFF00FFFF)
+ 		 | ((*(inputPtr + 2*colIdx + 1) & 0xFF) << 16);
+ 	}
+
+ inputPtr -= pPlane->srcRowStep;
+ outputPtr += pPlane->dstWordPitch;
+ }
+}
+
+/* 2x decimation of an 8-bit luma plane, keeps every even sample */
+static Void Alg_CameraMirrorCopyRowsDecLuma(const Alg_CameraMirrorPlaneInfo *pPlane,
+ const UInt32 *srcPtr,
+ UInt32 *dstPtr)
+{
+ UInt32 rowIdx;
+ UInt32 colIdx;
+ const UInt32 *inputPtr;
+ UInt32 *outputPtr;
+ UInt32 word0;
+ UInt32 word1;
+
+ inputPtr = srcPtr + pPlane->lastRowOffset;
+ outputPtr = dstPtr + pPlane->dstOffset;
+ for(rowIdx = 0; rowIdx < pPlane->numOutRows; rowIdx++)
+ {
+ 	for(colIdx = 0; colIdx < pPlane->wordWidth; colIdx++)
+ 	{
+ 		word0 = *(inputPtr + 2*colIdx);
+ 		word1 = *(inputPtr + 2*colIdx + 1);
+ 		*(outputPtr + colIdx) = (word0 & 0xFF)
+ 		 | ((word0 >> 8) & 0xFF00)
+ 		 | ((word1 & 0xFF) << 16)
+ 		 | ((word1 << 8) & 0xFF000000);
+ 	}
+
+ inputPtr -= pPlane->srcRowStep;
+ outputPtr += pPlane->dstWordPitch;
+ }
+}
+
+/* 2x decimation of an interleaved UV plane, keeps every even UV pair */
+static Void Alg_CameraMirrorCopyRowsDecChroma(const Alg_CameraMirrorPlaneInfo *pPlane,
+ const UInt32 *srcPtr,
+ UInt32 *dstPtr)
+{
+ UInt32 rowIdx;
+ UInt32 colIdx;
+ const UInt32 *inputPtr;
+ UInt32 *outputPtr;
+
+ inputPtr = srcPtr + pPlane->lastRowOffset;
+ outputPtr = dstPtr + pPlane->dstOffset;
+ for(rowIdx = 0; rowIdx < pPlane->numOutRows; rowIdx++)
+ {
+ 	for(colIdx = 0; colIdx < pPlane->wordWidth; colIdx++)
+ 	{
+ 		*(outputPtr + colIdx) = (*(inputPtr + 2*colIdx) & 0xFFFF)
+ 		 | (*(inputPtr + 2*colIdx + 1) << 16);
+ 	}
+
+ inputPtr -= pPlane->srcRowStep;
+ outputPtr += pPlane->dstWordPitch;
+ }
+}
+
+static inline UInt32 Alg_CameraMirrorLumaSum(UInt32 word,
+ UInt32 *hist,
+ Bool isYuyv)
+{
+ UInt32 y0;
+ UInt32 y1;
+ UInt32 y2;
+ UInt32 y3;
+
+ y0 = word & 0xFF;
+ y2 = (word >> 16) & 0xFF;
+ hist[y0]++;
+ hist[y2]++;
+ if(isYuyv == TRUE)
+ {
+ return y0 + y2;
+ }
+ y1 = (word >> 8) & 0xFF;
+ y3 = word >> 24;
+ hist[y1]++;
+ hist[y3]++;
+ return y0 + y1 + y2 + y3;
+}
+
+/*
+ * Swaps the row pairs like Alg_CameraMirrorSwapRows and gathers luma
+ * statistics of the mirrored frame from the words it already has in
+ * registers. Histogram and block sums are kept on the stack and only copied
+ * to pStats at the end.
+ */
+static inline Void Alg_CameraMirrorSwapRowsStats(
+ const Alg_CameraMirrorPlaneInfo *pPlane,
+ const Alg_CameraMirrorStatsGrid *pGrid,
+ UInt32 *planePtr,
+ Alg_CameraMirrorLumaStats *pStats,
+ Bool isYuyv)
+{
+ UInt32 hist[ALG_CAMERAMIRROR_HIST_BINS];
+ UInt32 blkSum[ALG_CAMERAMIRROR_MAX_BLK_V * ALG_CAMERAMIRROR_MAX_BLK_H];
+ UInt32 rowIdx;
+ UInt32 colIdx;
+ UInt32 blkCol;
+ UInt32 blkRow;
+ UInt32 topBlk;
+ UInt32 botBlk;
+ UInt32 topSum;
+ UInt32 botSum;
+ UInt32 rowStart;
+ UInt32 rowEnd;
+ UInt32 colStart;
+ UInt32 numPix;
+ UInt32 totalSum = 0;
+ UInt32 *inputPtr;
+ UInt32 *outputPtr;
+ UInt32 top;
+ UInt32 bot;
+
+ memset(hist, 0, sizeof(hist));
+ memset(blkSum, 0, sizeof(blkSum));
+
+ inputPtr = planePtr;
+ outputPtr = planePtr + pPlane->lastRowOffset;
+ for(rowIdx = 0; rowIdx < pPlane->numRowPairs; rowIdx++)
+ {
+ /* Block rows are taken in the orientation of the mirrored frame */
+ topBlk = ((rowIdx * pGrid->numBlkV) / pGrid->numRows) * pGrid->numBlkH;
+ botBlk = (((pGrid->numRows - 1 - rowIdx) * pGrid->numBlkV)
+ / pGrid->numRows) * pGrid->numBlkH;
+ colIdx = 0;
+ for(blkCol = 0; blkCol < pGrid->numBlkH; blkCol++)
+ {
+ topSum = 0;
+ botSum = 0;
+ for(; colIdx < pGrid->blkColEnd[blkCol]; colIdx++)
+ {
+ top = *(inputPtr + colIdx);
+ bot = *(outputPtr + colIdx);
+ *(inputPtr + colIdx) = bot;
+ *(outputPtr + colIdx) = top;
+ topSum += Alg_CameraMirrorLumaSum(bot, hist, isYuyv);
+ botSum += Alg_CameraMirrorLumaSum(top, hist, isYuyv);
+ }
+ blkSum[topBlk + blkCol] += topSum;
+ blkSum[botBlk + blkCol] += botSum;
+ }
+
+ inputPtr += pPlane->wordPitch;
+ outputPtr -= pPlane->wordPitch;
+ }
+
+ /* Middle row of odd heights stays in place but still counts */
+ if((pGrid->numRows & 0x1) != 0)
+ {
+ topBlk = ((rowIdx * pGrid->numBlkV) / pGrid->numRows) * pGrid->numBlkH;
+ colIdx = 0;
+ for(blkCol = 0; blkCol < pGrid->numBlkH; blkCol++)
+ {
+ for(; colIdx < pGrid->blkColEnd[blkCol]; colIdx++)
+ {
+ blkSum[topBlk + blkCol] +=
+ Alg_CameraMirrorLumaSum(*(inputPtr + colIdx), hist, isYuyv);
+ }
+ }
+ }
+
+ pStats->magic = ALG_CAMERAMIRROR_LUMA_STATS_MAGIC;
+ pStats->width = pGrid->blkColEnd[pGrid->numBlkH - 1] * pGrid->pixPerWord;
+ pStats->height = pGrid->numRows;
+ pStats->numBlkH = pGrid->numBlkH;
+ pStats->numBlkV = pGrid->numBlkV;
+ memcpy(pStats->hist, hist, sizeof(hist));
+
+ for(blkRow = 0; blkRow < pGrid->numBlkV; blkRow++)
+ {
+ /* Rows r with r * numBlkV / numRows == blkRow */
+ rowStart = (blkRow * pGrid->numRows + pGrid->numBlkV - 1) / pGrid->numBlkV;
+ rowEnd = ((blkRow + 1) * pGrid->numRows + pGrid->numBlkV - 1)
+ / pGrid->numBlkV;
+ colStart = 0;
+ for(blkCol = 0; blkCol < pGrid->numBlkH; blkCol++)
+ {
+ numPix = (rowEnd - rowStart) * (pGrid->blkColEnd[blkCol] - colStart)
+ * pGrid->pixPerWord;
+ topBlk = blkRow * pGrid->numBlkH + blkCol;
+ pStats->blkMean[topBlk] = (numPix != 0) ? (blkSum[topBlk] / numPix) : 0;
+ totalSum += blkSum[topBlk];
+ colStart = pGrid->blkColEnd[blkCol];
+ }
+ }
+ pStats->lumaMean = totalSum / (pStats->width * pStats->height);
+}
+
+static Void Alg_CameraMirrorSwapRowsStatsYuyv(
+ const Alg_CameraMirrorPlaneInfo *pPlane,
+ const Alg_CameraMirrorStatsGrid *pGrid,
+ UInt32 *planePtr,
+ Alg_CameraMirrorLumaStats *pStats)
+{
+ Alg_CameraMirrorSwapRowsStats(pPlane, pGrid, planePtr, pStats, TRUE);
+}
+
+static Void Alg_CameraMirrorSwapRowsStatsLuma(
+ const Alg_CameraMirrorPlaneInfo *pPlane,
+ const Alg_CameraMirrorStatsGrid *pGrid,
+ UInt32 *planePtr,
+ Alg_CameraMirrorLumaStats *pStats)
+{
+ Alg_CameraMirrorSwapRowsStats(pPlane, pGrid, planePtr, pStats, FALSE);
+}
+
+static Int32 Alg_CameraMirrorStatsGridInit(Alg_CameraMirrorStatsGrid *pGrid,
+ const Alg_CameraMirrorControlParams *pControlParams,
+ const Alg_CameraMirrorPlaneInfo *pPlane,
+ UInt32 numRows,
+ UInt32 pixPerWord)
+{
+ UInt32 blkCol;
+
+ if((pControlParams->numBlkH == 0) || (pControlParams->numBlkV == 0)
+ || (pControlParams->numBlkH > pPlane->wordWidth)
+ || (pControlParams->numBlkV > numRows))
+ {
+ return SYSTEM_LINK_STATUS_EFAIL;
+ }
+ pGrid->numBlkH = pControlParams->numBlkH;
+ pGrid->numBlkV = pControlParams->numBlkV;
+ pGrid->numRows = numRows;
+ pGrid->pixPerWord = pixPerWord;
+ for(blkCol = 0; blkCol < pGrid->numBlkH; blkCol++)
+ {
+ pGrid->blkColEnd[blkCol] =
+ ((blkCol + 1) * pPlane->wordWidth) / pGrid->numBlkH;
+ }
+ return SYSTEM_LINK_STATUS_SOK;
+}
+
+static Int32 Alg_CameraMirrorPlaneInit(Alg_CameraMirrorPlaneInfo *pPlane,
+ UInt32 rowBytes,
+ UInt32 numRows,
+ UInt32 pitch)
+{
+ /* Kernels work on whole 32-bit words */
+ if(((rowBytes & 0x3) != 0) || ((pitch & 0x3) != 0) || (numRows == 0))
+ {
+ return SYSTEM_LINK_STATUS_EFAIL;
+ }
+ pPlane->wordWidth = rowBytes >> 2;
+ pPlane->wordPitch = pitch >> 2;
+ pPlane->numRowPairs = numRows / 2;
+ pPlane->lastRowOffset = (numRows - 1) * pPlane->wordPitch;
+ pPlane->cacheSize = (numRows - 1) * pitch + rowBytes;
+ return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 Alg_CameraMirrorPlanCreate(Alg_CameraMirror_Obj *algHandle,
+ Alg_CameraMirrorPlan *pPlan,
+ UInt32 width,
+ UInt32 height,
+ UInt32 inPitch[],
+ UInt32 dataFormat
+ )
+{
+ Int32 status;
+ UInt32 planeIdx;
+ Bool isEven = TRUE;
+
+ memset(pPlan, 0, sizeof(Alg_CameraMirrorPlan));
+
+ if(dataFormat == SYSTEM_DF_YUV422I_YUYV)
+ {
+ pPlan->numPlanes = 1;
+ status = Alg_CameraMirrorPlaneInit(&pPlan->plane[0],
+ width*2, height, inPitch[0]);
+ }
+ else if(dataFormat == SYSTEM_DF_YUV420SP_UV)
+ {
+ pPlan->numPlanes = 2;
+ status = Alg_CameraMirrorPlaneInit(&pPlan->plane[0],
+ width, height, inPitch[0]);
+ if(status == SYSTEM_LINK_STATUS_SOK)
+ {
+ status = Alg_CameraMirrorPlaneInit(&pPlan->plane[1],
+ width, height/2, inPitch[1]);
+ }
+ }
+ else
+ {
+ status = SYSTEM_LINK_STATUS_EFAIL;
+ }
+
+ if(status != SYSTEM_LINK_STATUS_SOK)
+ {
+ pPlan->kernelFxn = NULL;
+ return status;
+ }
+
+ for(planeIdx = 0; planeIdx < pPlan->numPlanes; planeIdx++)
+ {
+ if((pPlan->plane[planeIdx].wordWidth & 0x1) != 0)
+ {
+ isEven = FALSE;
+ }
+ }
+ pPlan->kernelFxn = (isEven == TRUE) ? Alg_CameraMirrorSwapRowsX2
+ : Alg_CameraMirrorSwapRows;
+
+ /* Statistics are optional, a channel they do not fit still gets mirrored */
+ if((algHandle->controlParams.enableLumaStats != FALSE)
+ && (Alg_CameraMirrorStatsGridInit(&pPlan->statsGrid,
+ &algHandle->controlParams,
+ &pPlan->plane[0],
+ height,
+ (dataFormat == SYSTEM_DF_YUV422I_YUYV) ? 2 : 4)
+ == SYSTEM_LINK_STATUS_SOK))
+ {
+ pPlan->statsKernelFxn = (dataFormat == SYSTEM_DF_YUV422I_YUYV)
+ ? Alg_CameraMirrorSwapRowsStatsYuyv
+ : Alg_CameraMirrorSwapRowsStatsLuma;
+ }
+
+ return SYSTEM_LINK_STATUS_SOK;
+}
+
+static Int32 Alg_CameraMirrorTilePlaneInit(Alg_CameraMirrorPlaneInfo *pPlane,
+ UInt32 rowBytes,
+ UInt32 numRows,
+ UInt32 pitch,
+ UInt32 tileXBytes,
+ UInt32 tileY,
+ UInt32 outPitch,
+ Bool isDecimate,
+ UInt32 fillWord)
+{
+ UInt32 outRowBytes;
+ Int32 status;
+
+ status = Alg_CameraMirrorPlaneInit(pPlane, rowBytes, numRows, pitch);
+ if(status != SYSTEM_LINK_STATUS_SOK)
+ {
+ return status;
+ }
+ outRowBytes = (isDecimate == TRUE) ? (rowBytes / 2) : rowBytes;
+ pPlane->numOutRows = (isDecimate == TRUE) ? (numRows / 2) : numRows;
+ if(((outRowBytes & 0x3) != 0) || ((tileXBytes & 0x3) != 0)
+ || ((outPitch & 0x3) != 0) || (pPlane->numOutRows == 0))
+ {
+ return SYSTEM_LINK_STATUS_EFAIL;
+ }
+ pPlane->wordWidth = outRowBytes >> 2;
+ pPlane->srcRowStep = (isDecimate == TRUE) ? (2 * pPlane->wordPitch)
+ : pPlane->wordPitch;
+ pPlane->dstWordPitch = outPitch >> 2;
+ pPlane->dstOffset = (tileY * outPitch + tileXBytes) >> 2;
+ pPlane->dstCacheSize = (pPlane->numOutRows - 1) * outPitch + outRowBytes;
+ pPlane->dstFillWord = fillWord;
+ return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 Alg_CameraMirrorTilePlanCreate(Alg_CameraMirror_Obj *algHandle,
+ Alg_CameraMirrorPlan *pPlan,
+ UInt32 width,
+ UInt32 height,
+ UInt32 inPitch[],
+ UInt32 dataFormat,
+ UInt32 tileX,
+ UInt32 tileY,
+ UInt32 outPitch[],
+ Bool isDecimate
+ )
+{
+ Int32 status;
+
+ memset(pPlan, 0, sizeof(Alg_CameraMirrorPlan));
+
  if(dataFormat == SYSTEM_DF_YUV422I_YUYV)
  {
- wordWidth = (width*2)>>2;
+ pPlan->numPlanes = 1;
+ status = Alg_CameraMirrorTilePlaneInit(&pPlan->plane[0],
+ width*2, height, inPitch[0], tileX*2, tileY, outPitch[0], isDecimate,
+ 0x80108010U);
+ pPlan->copyKernelFxn[0] = (isDecimate == TRUE)
+ ? Alg_CameraMirrorCopyRowsDecYuyv
+ : Alg_CameraMirrorCopyRows;
+ }
+ else if(dataFormat == SYSTEM_DF_YUV420SP_UV)
+ {
+ if(isDecimate == TRUE)
+ {
+ /* Luma and chroma must keep the 2:1 row ratio after decimation */
+ height &= ~0x3U;
+ }
+ pPlan->numPlanes = 2;
+ status = Alg_CameraMirrorTilePlaneInit(&pPlan->plane[0],
+ width, height, inPitch[0], tileX, tileY, outPitch[0], isDecimate,
+ 0x10101010U);
+ if(status == SYSTEM_LINK_STATUS_SOK)
+ {
+ status = Alg_CameraMirrorTilePlaneInit(&pPlan->plane[1],
+ width, height/2, inPitch[1], tileX, tileY/2, outPitch[1],
+ isDecimate, 0x80808080U);
+ }
+ pPlan->copyKernelFxn[0] = (isDecimate == TRUE)
+ ? Alg_CameraMirrorCopyRowsDecLuma
+ : Alg_CameraMirrorCopyRows;
+ pPlan->copyKernelFxn[1] = (isDecimate == TRUE)
+ ? Alg_CameraMirrorCopyRowsDecChroma
+ : Alg_CameraMirrorCopyRows;
  }
  else
  {
+ status = SYSTEM_LINK_STATUS_EFAIL;
+ }
+
+ if(status != SYSTEM_LINK_STATUS_SOK)
+ {
+ memset(pPlan->copyKernelFxn, 0, sizeof(pPlan->copyKernelFxn));
+ }
+ return status;
+}
+
+Int32 Alg_CameraMirrorProcessTile(Alg_CameraMirror_Obj *algHandle,
+ const Alg_CameraMirrorPlan *pPlan,
+ UInt32 *inPtr[],
+ UInt32 *outPtr[]
+ )
+{
+ UInt32 planeIdx;
+
+ if(pPlan->copyKernelFxn[0] == NULL)
+ {
  return SYSTEM_LINK_STATUS_EFAIL;
  }
- inputPtr = inPtr[0];
+ for(planeIdx = 0; planeIdx < pPlan->numPlanes; planeIdx++)
+ {
+ pPlan->copyKernelFxn[planeIdx](&pPlan->plane[planeIdx],
+ inPtr[planeIdx], outPtr[planeIdx]);
+ }
+ return SYSTEM_LINK_STATUS_SOK;
+}
 
-//OVDJE ČAČKAT
+Int32 Alg_CameraMirrorClearTile(Alg_CameraMirror_Obj *algHandle,
+ const Alg_CameraMirrorPlan *pPlan,
+ UInt32 *outPtr[]
+ )
+{
+ UInt32 planeIdx;
+ UInt32 rowIdx;
+ UInt32 colIdx;
+ UInt32 *outputPtr;
+ const Alg_CameraMirrorPlaneInfo *pPlane;
 
- /* Add code for outputPtr assi2gnment, should start from end. */
- outputPtr = inPtr[0] + height * wordWidth - wordWidth;
- for(rowIdx = 0; rowIdx < height / 2; rowIdx++)
+ if(pPlan->copyKernelFxn[0] == NULL)
  {
- 	for(colIdx = 0; colIdx < wordWidth; colIdx++)
+ return SYSTEM_LINK_STATUS_EFAIL;
+ }
+ for(planeIdx = 0; planeIdx < pPlan->numPlanes; planeIdx++)
+ {
+ pPlane = &pPlan->plane[planeIdx];
+ outputPtr = outPtr[planeIdx] + pPlane->dstOffset;
+ for(rowIdx = 0; rowIdx < pPlane->numOutRows; rowIdx++)
+ {
+ 	for(colIdx = 0; colIdx < pPlane->wordWidth; colIdx++)
  	{
-	/* Add code for swapping values between inputPtr and outputPtr. */
- 		temp = *(inputPtr + colIdx);
- 		*(inputPtr + colIdx) = *(outputPtr + colIdx);
- 		*(outputPtr + colIdx) = temp;
+ 		*(outputPtr + colIdx) = pPlane->dstFillWord;
  	}
+ outputPtr += pPlane->dstWordPitch;
+ }
+ }
+ return SYSTEM_LINK_STATUS_SOK;
+}
 
- inputPtr += (inPitch[0] >> 2);
- /* Add code for decrementing outputPtr. */
- outputPtr -= (inPitch[0] >> 2);
+Int32 Alg_CameraMirrorProcess(Alg_CameraMirror_Obj *algHandle,
+ const Alg_CameraMirrorPlan *pPlan,
+ UInt32 *inPtr[],
+ Alg_CameraMirrorLumaStats *pStats
+ )
+{
+ UInt32 planeIdx = 0;
+
+ if(pPlan->kernelFxn == NULL)
+ {
+ return SYSTEM_LINK_STATUS_EFAIL;
+ }
+ if((pStats != NULL) && (pPlan->statsKernelFxn != NULL))
+ {
+ pPlan->statsKernelFxn(&pPlan->plane[0], &pPlan->statsGrid, inPtr[0], pStats);
+ planeIdx = 1;
+ }
+ for(; planeIdx < pPlan->numPlanes; planeIdx++)
+ {
+ pPlan->kernelFxn(&pPlan->plane[planeIdx], inPtr[planeIdx]);
  }
  return SYSTEM_LINK_STATUS_SOK;
 }
 
 Int32 Alg_CameraMirrorControl(Alg_CameraMirror_Obj *pAlgHandle,Alg_CameraMirrorControlParams *pControlParams)
 {
- /*
- * Any alteration of algorithm behavior
- */
+ if((pControlParams->enableLumaStats != FALSE)
+ && ((pControlParams->numBlkH == 0) || (pControlParams->numBlkV == 0)
+ || (pControlParams->numBlkH > ALG_CAMERAMIRROR_MAX_BLK_H)
+ || (pControlParams->numBlkV > ALG_CAMERAMIRROR_MAX_BLK_V)))
+ {
+ return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+ }
+ /* Takes effect once the plans are rebuilt */
+ memcpy(&pAlgHandle->controlParams, pControlParams,
+ sizeof(Alg_CameraMirrorControlParams));
  return SYSTEM_LINK_STATUS_SOK;
 }
 Int32 Alg_CameraMirrorStop(Alg_CameraMirror_Obj *algHandle)
@@ -93,6 +93,7 @@ Int32 AlgorithmLink_CameraMirrorCreate(void * pObj, void * pCreateParams)
 
     AlgorithmLink_CameraMirrorObj          * pCameraMirrorObj;
     AlgorithmLink_CameraMirrorCreateParams * pCameraMirrorCreateParams;
+    AlgorithmLink_CameraMirrorMosaicCreateParams * pMosaicCreateParams;
 
     pCameraMirrorCreateParams =
         (AlgorithmLink_CameraMirrorCreateParams *)pCreateParams;
@@ -108,6 +109,10 @@ Int32 AlgorithmLink_CameraMirrorCreate(void * pObj, void * pCreateParams)
 
     AlgorithmLink_setAlgorithmParamsObj(pObj, pCameraMirrorObj);
 
+    memset((void*)(&pCameraMirrorObj->controlParams),
+           0,
+           sizeof(Alg_CameraMirrorControlParams));
+
     /*
      * Taking copy of needed create time parameters in local object for future
      * reference.
@@ -120,6 +125,34 @@ Int32 AlgorithmLink_CameraMirrorCreate(void * pObj, void * pCreateParams)
            (void*)(&pCameraMirrorCreateParams->inQueParams),
            sizeof(System_LinkInQueParams));
 
+    /*
+     * Mosaic mode can only be requested through the extended create params,
+     * which are recognized by their size
+     */
+    pCameraMirrorObj->isMosaicMode            = FALSE;
+    pCameraMirrorObj->pCurOutBuf              = NULL;
+    pCameraMirrorObj->numIncompleteComposites = 0;
+    pCameraMirrorObj->numTilesCleared         = 0;
+    pCameraMirrorObj->numLateFrames           = 0;
+    memset((void*)(&pCameraMirrorObj->mosaicPrm),
+           0,
+           sizeof(AlgorithmLink_CameraMirrorMosaicParams));
+
+    if(pCameraMirrorCreateParams->baseClassCreate.size >=
+        sizeof(AlgorithmLink_CameraMirrorMosaicCreateParams))
+    {
+        pMosaicCreateParams =
+            (AlgorithmLink_CameraMirrorMosaicCreateParams *)pCreateParams;
+
+        if(pMosaicCreateParams->mosaicPrm.enableMosaic != FALSE)
+        {
+            memcpy((void*)(&pCameraMirrorObj->mosaicPrm),
+                   (void*)(&pMosaicCreateParams->mosaicPrm),
+                   sizeof(AlgorithmLink_CameraMirrorMosaicParams));
+            pCameraMirrorObj->isMosaicMode = TRUE;
+        }
+    }
+
     /*
      * Populating parameters corresponding to Q usage of color to gray
      * algorithm link
@@ -127,8 +160,16 @@ Int32 AlgorithmLink_CameraMirrorCreate(void * pObj, void * pCreateParams)
     numInputQUsed     = 1;
     numOutputQUsed    = 1;
 
-    inputQInfo.qMode  = ALGORITHM_LINK_QUEUEMODE_INPLACE;
-    outputQInfo.qMode = ALGORITHM_LINK_QUEUEMODE_INPLACE;
+    if(pCameraMirrorObj->isMosaicMode == TRUE)
+    {
+        inputQInfo.qMode  = ALGORITHM_LINK_QUEUEMODE_NOTINPLACE;
+        outputQInfo.qMode = ALGORITHM_LINK_QUEUEMODE_NOTINPLACE;
+    }
+    else
+    {
+        inputQInfo.qMode  = ALGORITHM_LINK_QUEUEMODE_INPLACE;
+        outputQInfo.qMode = ALGORITHM_LINK_QUEUEMODE_INPLACE;
+    }
 
     /*
      * If any output buffer Q gets used in INPLACE manner, then
@@ -180,6 +221,21 @@ Int32 AlgorithmLink_CameraMirrorCreate(void * pObj, void * pCreateParams)
           );
     }
 
+    /*
+     * In mosaic mode the output is a single channel carrying the composite
+     */
+    if(pCameraMirrorObj->isMosaicMode == TRUE)
+    {
+        status = AlgorithmLink_CameraMirrorMosaicInit(pCameraMirrorObj);
+        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+        outputQInfo.queInfo.numCh = 1;
+        memcpy((void *)&(outputQInfo.queInfo.chInfo[0]),
+               (void *)&(pCameraMirrorObj->outChInfo),
+               sizeof(System_LinkChInfo)
+              );
+    }
+
     /*
      * Initializations needed for book keeping of buffer handling.
      * Note that this needs to be called only after setting inputQMode and
@@ -203,11 +259,20 @@ Int32 AlgorithmLink_CameraMirrorCreate(void * pObj, void * pCreateParams)
 
     pCameraMirrorObj->algHandle = algHandle;
 
+    status = AlgorithmLink_CameraMirrorCreatePlans(pCameraMirrorObj);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+    if(pCameraMirrorObj->isMosaicMode == TRUE)
+    {
+        AlgorithmLink_CameraMirrorMosaicAllocBuffers(pObj, pCameraMirrorObj);
+    }
+
     pCameraMirrorObj->linkStatsInfo = Utils_linkStatsCollectorAllocInst(
         AlgorithmLink_getLinkId(pObj), "ALG_CAMERAMIRROR");
     UTILS_assert(NULL != pCameraMirrorObj->linkStatsInfo);
 
     pCameraMirrorObj->isFirstFrameRecv = FALSE;
+    pCameraMirrorObj->numStatsSkippedFrames = 0;
 
     return status;
 }
@@ -239,12 +304,11 @@ Int32 AlgorithmLink_CameraMirrorProcess(void * pObj)
     System_BufferList            inputBufListReturn;
     System_Buffer              * pSysBufferInput;
     System_VideoFrameBuffer    * pSysVideoFrameBufferInput;
-    UInt32                       dataFormat;
-    UInt32                       bufSize[SYSTEM_MAX_PLANES];
-    UInt32                       bufCntr;
-    UInt32                       numBuffs;
+    UInt32                       planeIdx;
     UInt32                       channelId;
-    System_LinkChInfo          * pInputChInfo;
+    Alg_CameraMirrorPlan       * pPlan;
+    Alg_CameraMirrorLumaStats  * pStats;
+    Bool                         isOwnMeta;
     Bool                         bufDropFlag = FALSE;
     System_LinkStatistics      * linkStatsInfo;
 
@@ -308,70 +372,145 @@ Int32 AlgorithmLink_CameraMirrorProcess(void * pObj)
           if((pSysBufferInput->bufType != SYSTEM_BUFFER_TYPE_VIDEO_FRAME)
              ||
              (channelId >= pCameraMirrorObj->numInputChannels)
+             ||
+             ((pCameraMirrorObj->chPlan[channelId].kernelFxn == NULL)
+              &&
+              (pCameraMirrorObj->chPlan[channelId].copyKernelFxn[0] == NULL))
             )
           {
             bufDropFlag = TRUE;
             linkStatsInfo->linkStats.inBufErrorCount++;
           }
+          else if(pCameraMirrorObj->isMosaicMode == TRUE)
+          {
+            /*
+             * Buffer is copied into the composite, input is released below
+             */
+            bufDropFlag = FALSE;
+            if(AlgorithmLink_CameraMirrorMosaicProcess(pObj,
+                                                       pCameraMirrorObj,
+                                                       pSysBufferInput)
+               != SYSTEM_LINK_STATUS_SOK)
+            {
+              bufDropFlag = TRUE;
+            }
+          }
           else
           {
 
           bufDropFlag = FALSE;
 
+          pPlan = &(pCameraMirrorObj->chPlan[channelId]);
+
           /*
-           * Call to the algorithm
+           * In place buffers come back from the producer with the statistics
+           * of an earlier trip through the pool still in the meta buffer,
+           * those are recognized by size and tag
            */
-          dataFormat = System_Link_Ch_Info_Get_Flag_Data_Format(
-                        pCameraMirrorObj->inputChInfo[channelId].flags);
-
-          pInputChInfo = &(pCameraMirrorObj->inputChInfo[channelId]);
-
+          isOwnMeta = FALSE;
+          if((pSysVideoFrameBufferInput->metaBufAddr != NULL)
+             &&
+             (pSysVideoFrameBufferInput->metaFillLength ==
+                sizeof(Alg_CameraMirrorLumaStats))
+            )
+          {
+            Cache_inv(pSysVideoFrameBufferInput->metaBufAddr,
+                      sizeof(UInt32),
+                      Cache_Type_ALL,
+                      TRUE
+                     );
+            if(((Alg_CameraMirrorLumaStats *)
+                    pSysVideoFrameBufferInput->metaBufAddr)->magic
+                == ALG_CAMERAMIRROR_LUMA_STATS_MAGIC)
+            {
+              isOwnMeta = TRUE;
+            }
+          }
 
-          switch (dataFormat)
+          /*
+           * Luma statistics go into the meta buffer of the frame, if the
+           * producer provided one which is large enough and did not put its
+           * own data (e.g. AEWB output of ISS capture) there
+           */
+          pStats = NULL;
+          if((pPlan->statsKernelFxn != NULL)
+             &&
+             (pSysVideoFrameBufferInput->metaBufAddr != NULL)
+             &&
+             ((pSysVideoFrameBufferInput->metaFillLength == 0)
+              ||
+              (isOwnMeta == TRUE))
+             &&
+             (pSysVideoFrameBufferInput->metaBufSize >=
+                sizeof(Alg_CameraMirrorLumaStats))
+            )
+          {
+            pStats = (Alg_CameraMirrorLumaStats *)
+                        pSysVideoFrameBufferInput->metaBufAddr;
+          }
+          else
           {
-              case SYSTEM_DF_YUV422I_YUYV:
-                  numBuffs    = 1;
-                  bufSize[0]  = ((pInputChInfo->height)*(pInputChInfo->pitch[0]));
-                  break;
-              case SYSTEM_DF_YUV420SP_UV:
-                  numBuffs    = 1;
-                  bufSize[0]  = ((pInputChInfo->height)*(pInputChInfo->pitch[0]));
-                  break;
-              default:
-                  numBuffs    = 1;
-                  bufSize[0]  = ((pInputChInfo->height)*(pInputChInfo->pitch[0]));
-                  UTILS_assert (0);
-                  break;
+            if(pCameraMirrorObj->controlParams.enableLumaStats != FALSE)
+            {
+              pCameraMirrorObj->numStatsSkippedFrames++;
+            }
+
+            /*
+             * Stale statistics must not be taken for the ones of this frame
+             */
+            if(isOwnMeta == TRUE)
+            {
+              ((Alg_CameraMirrorLumaStats *)
+                    pSysVideoFrameBufferInput->metaBufAddr)->magic = 0;
+              pSysVideoFrameBufferInput->metaFillLength = 0;
+              Cache_wb(pSysVideoFrameBufferInput->metaBufAddr,
+                       sizeof(UInt32),
+                       Cache_Type_ALL,
+                       TRUE
+                      );
+            }
           }
 
           pSysBufferInput->linkLocalTimestamp = Utils_getCurGlobalTimeInUsec();
 
-          for(bufCntr = 0; bufCntr < numBuffs; bufCntr++)
+          for(planeIdx = 0; planeIdx < pPlan->numPlanes; planeIdx++)
           {
-            Cache_inv(pSysVideoFrameBufferInput->bufAddr[bufCntr],
-                      bufSize[bufCntr],
+            Cache_inv(pSysVideoFrameBufferInput->bufAddr[planeIdx],
+                      pPlan->plane[planeIdx].cacheSize,
                       Cache_Type_ALL,
                       TRUE
                      );
           }
 
+          /*
+           * Call to the algorithm
+           */
           Alg_CameraMirrorProcess(algHandle,
-                               (UInt32 **)pSysVideoFrameBufferInput->bufAddr,
-                               pInputChInfo->width,
-                               pInputChInfo->height,
-                               pInputChInfo->pitch,
-                               dataFormat
-                              );
-
-          for(bufCntr = 0; bufCntr < numBuffs; bufCntr++)
+                                  pPlan,
+                                  (UInt32 **)pSysVideoFrameBufferInput->bufAddr,
+                                  pStats
+                                 );
+
+          for(planeIdx = 0; planeIdx < pPlan->numPlanes; planeIdx++)
           {
-            Cache_wb(pSysVideoFrameBufferInput->bufAddr[bufCntr],
-                      bufSize[bufCntr],
+            Cache_wb(pSysVideoFrameBufferInput->bufAddr[planeIdx],
+                      pPlan->plane[planeIdx].cacheSize,
                       Cache_Type_ALL,
                       TRUE
                      );
           }
 
+          if(pStats != NULL)
+          {
+            pSysVideoFrameBufferInput->metaFillLength =
+                sizeof(Alg_CameraMirrorLumaStats);
+            Cache_wb(pStats,
+                     sizeof(Alg_CameraMirrorLumaStats),
+                     Cache_Type_ALL,
+                     TRUE
+                    );
+          }
+
           Utils_updateLatency(&linkStatsInfo->linkLatency,
                               pSysBufferInput->linkLocalTimestamp);
           Utils_updateLatency(&linkStatsInfo->srcToLinkLatency,
@@ -442,6 +581,7 @@ Int32 AlgorithmLink_CameraMirrorControl(void * pObj, void * pControlParams)
 {
     AlgorithmLink_CameraMirrorObj     * pCameraMirrorObj;
     AlgorithmLink_ControlParams      * pAlgLinkControlPrm;
+    AlgorithmLink_CameraMirrorControlParams * pCameraMirrorControlPrm;
     Alg_CameraMirror_Obj              * algHandle;
     Int32                        status    = SYSTEM_LINK_STATUS_SOK;
 
@@ -464,6 +604,44 @@ Int32 AlgorithmLink_CameraMirrorControl(void * pObj, void * pControlParams)
             AlgorithmLink_CameraMirrorPrintStatistics(pObj, pCameraMirrorObj);
             break;
 
+        case ALGORITHM_LINK_CAMERAMIRROR_CMD_SET_CONTROL_PARAMS:
+            pCameraMirrorControlPrm =
+                (AlgorithmLink_CameraMirrorControlParams *)pControlParams;
+
+            /*
+             * Tiles are copied out of place, there is no meta buffer of the
+             * input frame to carry luma statistics
+             */
+            if((pCameraMirrorObj->isMosaicMode == TRUE)
+               &&
+               (pCameraMirrorControlPrm->algControlParams.enableLumaStats
+                    != FALSE))
+            {
+                status = SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+                break;
+            }
+
+            status = Alg_CameraMirrorControl(algHandle,
+                            &(pCameraMirrorControlPrm->algControlParams)
+                           );
+            if(status == SYSTEM_LINK_STATUS_SOK)
+            {
+                memcpy((void*)(&pCameraMirrorObj->controlParams),
+                       (void*)(&pCameraMirrorControlPrm->algControlParams),
+                       sizeof(Alg_CameraMirrorControlParams));
+
+                /*
+                 * Tile plans do not depend on the control params, the
+                 * pending composite stays valid
+                 */
+                if(pCameraMirrorObj->isMosaicMode == FALSE)
+                {
+                    status = AlgorithmLink_CameraMirrorCreatePlans(
+                                                pCameraMirrorObj);
+                }
+            }
+            break;
+
         default:
             status = Alg_CameraMirrorControl(algHandle,
                                             &(pCameraMirrorObj->controlParams)
@@ -480,10 +658,8 @@ Int32 AlgorithmLink_CameraMirrorControl(void * pObj, void * pControlParams)
  *
  * \brief Implementation of Stop Plugin for color to gray algorithm link
  *
- *        For this algorithm there is no locking of frames and hence no
- *        flushing of frames. Also there are no any other functionality to be
- *        done at the end of execution of this algorithm. Hence this function
- *        is an empty function for this algorithm.
+ *        Input frames are never locked. In mosaic mode the composite which
+ *        is being filled is returned to the free output queue.
  *
  * \param  pObj              [IN] Algorithm link object handle
  *
@@ -493,6 +669,22 @@ Int32 AlgorithmLink_CameraMirrorControl(void * pObj, void * pControlParams)
  */
 Int32 AlgorithmLink_CameraMirrorStop(void * pObj)
 {
+    AlgorithmLink_CameraMirrorObj * pCameraMirrorObj;
+
+    pCameraMirrorObj = (AlgorithmLink_CameraMirrorObj *)
+                        AlgorithmLink_getAlgorithmParamsObj(pObj);
+
+    /*
+     * A partially filled composite goes back to the free queue
+     */
+    if(pCameraMirrorObj->pCurOutBuf != NULL)
+    {
+        AlgorithmLink_putEmptyOutputBuffer(pObj,
+                                           0,
+                                           pCameraMirrorObj->pCurOutBuf);
+        pCameraMirrorObj->pCurOutBuf = NULL;
+    }
+
     return SYSTEM_LINK_STATUS_SOK;
 }
 
@@ -523,11 +715,604 @@ Int32 AlgorithmLink_CameraMirrorDelete(void * pObj)
     status = Alg_CameraMirrorDelete(algHandle);
     UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
 
+    if(pCameraMirrorObj->isMosaicMode == TRUE)
+    {
+        AlgorithmLink_CameraMirrorMosaicFreeBuffers(pCameraMirrorObj);
+    }
+
     free(pCameraMirrorObj);
 
     return SYSTEM_LINK_STATUS_SOK;
 }
 
+/**
+ *******************************************************************************
+ *
+ * \brief Build the per channel processing plans
+ *
+ *        Everything which only depends on the channel info (kernel, plane
+ *        geometry, cache ranges) is computed here once, so that the process
+ *        call only has to look up the plan of the channel and run it.
+ *        Channels whose format can not be handled get a plan without kernel,
+ *        are reported here and their buffers are dropped. This is not an
+ *        error of the link, the other channels keep running.
+ *
+ * \param  pCameraMirrorObj    [IN] Camera mirror link object
+ *
+ * \return  SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 AlgorithmLink_CameraMirrorCreatePlans(
+                     AlgorithmLink_CameraMirrorObj *pCameraMirrorObj)
+{
+    Int32                        status = SYSTEM_LINK_STATUS_SOK;
+    Int32                        planStatus;
+    UInt32                       channelId;
+    UInt32                       dataFormat;
+    UInt32                       numTiles;
+    UInt32                       compositeDataFormat;
+    System_LinkChInfo          * pInputChInfo;
+
+    numTiles = pCameraMirrorObj->mosaicPrm.numTilesH
+                * pCameraMirrorObj->mosaicPrm.numTilesV;
+    compositeDataFormat = System_Link_Ch_Info_Get_Flag_Data_Format(
+                            pCameraMirrorObj->outChInfo.flags);
+
+    pCameraMirrorObj->tileValidMask = 0;
+
+    for(channelId = 0;
+        channelId < pCameraMirrorObj->numInputChannels;
+        channelId++)
+    {
+        pInputChInfo = &(pCameraMirrorObj->inputChInfo[channelId]);
+
+        dataFormat = System_Link_Ch_Info_Get_Flag_Data_Format(
+                        pInputChInfo->flags);
+
+        if(pCameraMirrorObj->isMosaicMode == TRUE)
+        {
+            /*
+             * Every channel needs a tile and the format of the composite
+             */
+            memset(&(pCameraMirrorObj->chPlan[channelId]),
+                   0,
+                   sizeof(Alg_CameraMirrorPlan));
+
+            if(channelId >= numTiles)
+            {
+                Vps_printf(" ALG_CAMERAMIRROR: CH%d: No tile in %dx%d"
+                           " mosaic !!!\n",
+                           channelId,
+                           pCameraMirrorObj->mosaicPrm.numTilesH,
+                           pCameraMirrorObj->mosaicPrm.numTilesV);
+                continue;
+            }
+
+            if(dataFormat != compositeDataFormat)
+            {
+                Vps_printf(" ALG_CAMERAMIRROR: CH%d: Format %d differs from"
+                           " composite format %d !!!\n",
+                           channelId, dataFormat, compositeDataFormat);
+                continue;
+            }
+
+            planStatus = Alg_CameraMirrorTilePlanCreate(
+                pCameraMirrorObj->algHandle,
+                &(pCameraMirrorObj->chPlan[channelId]),
+                pInputChInfo->width,
+                pInputChInfo->height,
+                pInputChInfo->pitch,
+                dataFormat,
+                (channelId % pCameraMirrorObj->mosaicPrm.numTilesH)
+                    * pCameraMirrorObj->tileWidth,
+                (channelId / pCameraMirrorObj->mosaicPrm.numTilesH)
+                    * pCameraMirrorObj->tileHeight,
+                pCameraMirrorObj->outChInfo.pitch,
+                (pCameraMirrorObj->mosaicPrm.enableDecimation != FALSE)
+                    ? TRUE : FALSE
+                );
+
+            if(planStatus == SYSTEM_LINK_STATUS_SOK)
+            {
+                pCameraMirrorObj->tileValidMask |= (1U << channelId);
+            }
+        }
+        else
+        {
+            planStatus = Alg_CameraMirrorPlanCreate(
+                    pCameraMirrorObj->algHandle,
+                    &(pCameraMirrorObj->chPlan[channelId]),
+                    pInputChInfo->width,
+                    pInputChInfo->height,
+                    pInputChInfo->pitch,
+                    dataFormat
+                    );
+        }
+
+        if(planStatus != SYSTEM_LINK_STATUS_SOK)
+        {
+            Vps_printf(" ALG_CAMERAMIRROR: CH%d: Unsupported format %d"
+                       " (%dx%d) !!!\n",
+                       channelId, dataFormat,
+                       pInputChInfo->width, pInputChInfo->height);
+        }
+        else if((pCameraMirrorObj->controlParams.enableLumaStats != FALSE)
+                &&
+                (pCameraMirrorObj->chPlan[channelId].statsKernelFxn == NULL))
+        {
+            Vps_printf(" ALG_CAMERAMIRROR: CH%d: %dx%d blocks do not fit"
+                       " (%dx%d), luma statistics disabled !!!\n",
+                       channelId,
+                       pCameraMirrorObj->controlParams.numBlkH,
+                       pCameraMirrorObj->controlParams.numBlkV,
+                       pInputChInfo->width, pInputChInfo->height);
+        }
+    }
+
+    return status;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Set up the composite layout of the mosaic mode
+ *
+ *        The composite has the data format of channel 0. Every tile is as
+ *        large as the largest (decimated) input channel, rounded so that
+ *        tiles start on word boundaries of every plane.
+ *
+ * \param  pCameraMirrorObj    [IN] Camera mirror link object
+ *
+ * \return  SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 AlgorithmLink_CameraMirrorMosaicInit(
+                     AlgorithmLink_CameraMirrorObj *pCameraMirrorObj)
+{
+    AlgorithmLink_CameraMirrorMosaicParams * pMosaicPrm;
+    System_LinkChInfo          * pOutChInfo;
+    UInt32                       channelId;
+    UInt32                       dataFormat;
+    UInt32                       width;
+    UInt32                       height;
+    UInt32                       decShift;
+
+    pMosaicPrm = &(pCameraMirrorObj->mosaicPrm);
+    pOutChInfo = &(pCameraMirrorObj->outChInfo);
+
+    if((pMosaicPrm->numTilesH == 0) || (pMosaicPrm->numTilesV == 0)
+       ||
+       ((pMosaicPrm->numTilesH * pMosaicPrm->numTilesV) > 32U)
+       ||
+       (pMosaicPrm->numOutBuffers == 0)
+       ||
+       (pMosaicPrm->numOutBuffers > FRAMECOPY_LINK_MAX_FRAMES)
+       ||
+       (pCameraMirrorObj->numInputChannels == 0)
+      )
+    {
+        return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+    }
+
+    decShift = (pMosaicPrm->enableDecimation != FALSE) ? 1 : 0;
+
+    dataFormat = System_Link_Ch_Info_Get_Flag_Data_Format(
+                    pCameraMirrorObj->inputChInfo[0].flags);
+
+    /*
+     * Channels without a tile or with another format than channel 0 never
+     * get a tile plan and do not count for the tile size
+     */
+    pCameraMirrorObj->tileWidth  = 0;
+    pCameraMirrorObj->tileHeight = 0;
+    for(channelId = 0;
+        (channelId < pCameraMirrorObj->numInputChannels)
+        &&
+        (channelId < (pMosaicPrm->numTilesH * pMosaicPrm->numTilesV));
+        channelId++)
+    {
+        if(System_Link_Ch_Info_Get_Flag_Data_Format(
+                pCameraMirrorObj->inputChInfo[channelId].flags) != dataFormat)
+        {
+            continue;
+        }
+
+        width  = pCameraMirrorObj->inputChInfo[channelId].width >> decShift;
+        height = pCameraMirrorObj->inputChInfo[channelId].height >> decShift;
+
+        if(width > pCameraMirrorObj->tileWidth)
+        {
+            pCameraMirrorObj->tileWidth = width;
+        }
+        if(height > pCameraMirrorObj->tileHeight)
+        {
+            pCameraMirrorObj->tileHeight = height;
+        }
+    }
+    pCameraMirrorObj->tileWidth  = SystemUtils_align(
+                                    pCameraMirrorObj->tileWidth, 4);
+    pCameraMirrorObj->tileHeight = SystemUtils_align(
+                                    pCameraMirrorObj->tileHeight, 2);
+
+    memcpy((void *)pOutChInfo,
+           (void *)&(pCameraMirrorObj->inputChInfo[0]),
+           sizeof(System_LinkChInfo));
+
+    pOutChInfo->startX = 0;
+    pOutChInfo->startY = 0;
+    pOutChInfo->width  = pCameraMirrorObj->tileWidth * pMosaicPrm->numTilesH;
+    pOutChInfo->height = pCameraMirrorObj->tileHeight * pMosaicPrm->numTilesV;
+
+    dataFormat = System_Link_Ch_Info_Get_Flag_Data_Format(pOutChInfo->flags);
+
+    switch (dataFormat)
+    {
+        case SYSTEM_DF_YUV422I_YUYV:
+            pCameraMirrorObj->numOutPlanes = 1;
+            pOutChInfo->pitch[0] = SystemUtils_align(pOutChInfo->width * 2, 32);
+            pCameraMirrorObj->outBufSize[0] =
+                pOutChInfo->pitch[0] * pOutChInfo->height;
+            break;
+        case SYSTEM_DF_YUV420SP_UV:
+            pCameraMirrorObj->numOutPlanes = 2;
+            pOutChInfo->pitch[0] = SystemUtils_align(pOutChInfo->width, 32);
+            pOutChInfo->pitch[1] = pOutChInfo->pitch[0];
+            pCameraMirrorObj->outBufSize[0] =
+                pOutChInfo->pitch[0] * pOutChInfo->height;
+            pCameraMirrorObj->outBufSize[1] =
+                pOutChInfo->pitch[1] * pOutChInfo->height / 2;
+            break;
+        default:
+            return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Allocate the composite buffers and queue them as free output
+ *
+ *        Buffers are cleared to black once, so that tiles of smaller or
+ *        missing channels do not show uninitialized memory.
+ *
+ * \param  pObj                [IN] Algorithm link object handle
+ * \param  pCameraMirrorObj    [IN] Camera mirror link object
+ *
+ * \return  SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 AlgorithmLink_CameraMirrorMosaicAllocBuffers(void * pObj,
+                     AlgorithmLink_CameraMirrorObj *pCameraMirrorObj)
+{
+    Int32                        status = SYSTEM_LINK_STATUS_SOK;
+    UInt32                       frameIdx;
+    UInt32                       planeIdx;
+    UInt32                       wordIdx;
+    UInt32                       dataFormat;
+    System_Buffer              * pSystemBuffer;
+    System_VideoFrameBuffer    * pSystemVideoFrameBuffer;
+
+    dataFormat = System_Link_Ch_Info_Get_Flag_Data_Format(
+                    pCameraMirrorObj->outChInfo.flags);
+
+    for(frameIdx = 0;
+        frameIdx < pCameraMirrorObj->mosaicPrm.numOutBuffers;
+        frameIdx++)
+    {
+        pSystemBuffer           = &(pCameraMirrorObj->buffers[frameIdx]);
+        pSystemVideoFrameBuffer = &(pCameraMirrorObj->videoFrames[frameIdx]);
+
+        memset(pSystemBuffer, 0, sizeof(System_Buffer));
+        memset(pSystemVideoFrameBuffer, 0, sizeof(System_VideoFrameBuffer));
+
+        pSystemBuffer->payload     = pSystemVideoFrameBuffer;
+        pSystemBuffer->payloadSize = sizeof(System_VideoFrameBuffer);
+        pSystemBuffer->bufType     = SYSTEM_BUFFER_TYPE_VIDEO_FRAME;
+        pSystemBuffer->chNum       = 0;
+
+        memcpy((void *)&(pSystemVideoFrameBuffer->chInfo),
+               (void *)&(pCameraMirrorObj->outChInfo),
+               sizeof(System_LinkChInfo));
+
+        for(planeIdx = 0;
+            planeIdx < pCameraMirrorObj->numOutPlanes;
+            planeIdx++)
+        {
+            pSystemVideoFrameBuffer->bufAddr[planeIdx] =
+                Utils_memAlloc(UTILS_HEAPID_DDR_CACHED_SR,
+                               pCameraMirrorObj->outBufSize[planeIdx],
+                               ALGORITHMLINK_FRAME_ALIGN);
+            UTILS_assert(pSystemVideoFrameBuffer->bufAddr[planeIdx] != NULL);
+
+            if(dataFormat == SYSTEM_DF_YUV422I_YUYV)
+            {
+                for(wordIdx = 0;
+                    wordIdx < (pCameraMirrorObj->outBufSize[planeIdx] >> 2);
+                    wordIdx++)
+                {
+                    ((UInt32 *)pSystemVideoFrameBuffer->bufAddr[planeIdx])
+                        [wordIdx] = 0x80108010U;
+                }
+            }
+            else
+            {
+                memset(pSystemVideoFrameBuffer->bufAddr[planeIdx],
+                       (planeIdx == 0) ? 0x10 : 0x80,
+                       pCameraMirrorObj->outBufSize[planeIdx]);
+            }
+
+            Cache_wb(pSystemVideoFrameBuffer->bufAddr[planeIdx],
+                     pCameraMirrorObj->outBufSize[planeIdx],
+                     Cache_Type_ALL,
+                     TRUE
+                    );
+        }
+
+        status = AlgorithmLink_putEmptyOutputBuffer(pObj, 0, pSystemBuffer);
+        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+    }
+
+    return status;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Free the composite buffers
+ *
+ * \param  pCameraMirrorObj    [IN] Camera mirror link object
+ *
+ * \return  SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 AlgorithmLink_CameraMirrorMosaicFreeBuffers(
+                     AlgorithmLink_CameraMirrorObj *pCameraMirrorObj)
+{
+    Int32                        status;
+    UInt32                       frameIdx;
+    UInt32                       planeIdx;
+
+    for(frameIdx = 0;
+        frameIdx < pCameraMirrorObj->mosaicPrm.numOutBuffers;
+        frameIdx++)
+    {
+        for(planeIdx = 0;
+            planeIdx < pCameraMirrorObj->numOutPlanes;
+            planeIdx++)
+        {
+            status = Utils_memFree(UTILS_HEAPID_DDR_CACHED_SR,
+                        pCameraMirrorObj->videoFrames[frameIdx].bufAddr[planeIdx],
+                        pCameraMirrorObj->outBufSize[planeIdx]);
+            UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+        }
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Write one input frame into its tile of the composite
+ *
+ *        A new composite is started when none is pending. The pending one is
+ *        emitted first when the channel already has its tile filled or the
+ *        frame is past the timestamp window, and right after this frame
+ *        when all channels have arrived. Frames from before the window are
+ *        dropped as late.
+ *
+ * \param  pObj                [IN] Algorithm link object handle
+ * \param  pCameraMirrorObj    [IN] Camera mirror link object
+ * \param  pSysBufferInput     [IN] Validated input buffer
+ *
+ * \return  SYSTEM_LINK_STATUS_SOK if the frame went into a composite
+ *
+ *******************************************************************************
+ */
+Int32 AlgorithmLink_CameraMirrorMosaicProcess(void * pObj,
+                     AlgorithmLink_CameraMirrorObj *pCameraMirrorObj,
+                     System_Buffer *pSysBufferInput)
+{
+    Int32                        status;
+    UInt32                       channelId;
+    UInt32                       planeIdx;
+    UInt32                       windowUs;
+    Alg_CameraMirrorPlan       * pPlan;
+    System_VideoFrameBuffer    * pSysVideoFrameBufferInput;
+    System_VideoFrameBuffer    * pSysVideoFrameBufferOutput;
+    System_LinkStatistics      * linkStatsInfo;
+
+    linkStatsInfo = pCameraMirrorObj->linkStatsInfo;
+    channelId     = pSysBufferInput->chNum;
+    pPlan         = &(pCameraMirrorObj->chPlan[channelId]);
+    windowUs      = pCameraMirrorObj->mosaicPrm.windowUs;
+
+    pSysVideoFrameBufferInput = pSysBufferInput->payload;
+
+    if(pCameraMirrorObj->pCurOutBuf != NULL)
+    {
+        /*
+         * A frame older than the window of the pending composite arrived
+         * too late for it and for every later one
+         */
+        if((windowUs != 0)
+           &&
+           ((pSysBufferInput->srcTimestamp + windowUs) <
+                pCameraMirrorObj->windowStartTimestamp)
+          )
+        {
+            pCameraMirrorObj->numLateFrames++;
+            linkStatsInfo->linkStats.chStats[channelId].inBufDropCount++;
+            return SYSTEM_LINK_STATUS_EFAIL;
+        }
+
+        if(((pCameraMirrorObj->tileFilledMask & (1U << channelId)) != 0)
+           ||
+           ((windowUs != 0)
+            &&
+            (pSysBufferInput->srcTimestamp >
+                (pCameraMirrorObj->windowStartTimestamp + windowUs)))
+          )
+        {
+            pCameraMirrorObj->numIncompleteComposites++;
+            AlgorithmLink_CameraMirrorMosaicEmit(pObj, pCameraMirrorObj);
+        }
+    }
+
+    if(pCameraMirrorObj->pCurOutBuf == NULL)
+    {
+        status = AlgorithmLink_getEmptyOutputBuffer(pObj,
+                                                    0,
+                                                    0,
+                                                    &pCameraMirrorObj->pCurOutBuf);
+        if(status != SYSTEM_LINK_STATUS_SOK)
+        {
+            pCameraMirrorObj->pCurOutBuf = NULL;
+            linkStatsInfo->linkStats.chStats[channelId].inBufDropCount++;
+            linkStatsInfo->linkStats.chStats[channelId].outBufDropCount[0]++;
+            return status;
+        }
+
+        pCameraMirrorObj->windowStartTimestamp = pSysBufferInput->srcTimestamp;
+        pCameraMirrorObj->tileFilledMask       = 0;
+    }
+
+    pSysVideoFrameBufferOutput = pCameraMirrorObj->pCurOutBuf->payload;
+
+    pSysBufferInput->linkLocalTimestamp = Utils_getCurGlobalTimeInUsec();
+
+    for(planeIdx = 0; planeIdx < pPlan->numPlanes; planeIdx++)
+    {
+        Cache_inv(pSysVideoFrameBufferInput->bufAddr[planeIdx],
+                  pPlan->plane[planeIdx].cacheSize,
+                  Cache_Type_ALL,
+                  TRUE
+                 );
+    }
+
+    Alg_CameraMirrorProcessTile(pCameraMirrorObj->algHandle,
+                                pPlan,
+                                (UInt32 **)pSysVideoFrameBufferInput->bufAddr,
+                                (UInt32 **)pSysVideoFrameBufferOutput->bufAddr
+                               );
+
+    for(planeIdx = 0; planeIdx < pPlan->numPlanes; planeIdx++)
+    {
+        Cache_wb((UInt32 *)pSysVideoFrameBufferOutput->bufAddr[planeIdx]
+                    + pPlan->plane[planeIdx].dstOffset,
+                 pPlan->plane[planeIdx].dstCacheSize,
+                 Cache_Type_ALL,
+                 TRUE
+                );
+    }
+
+    Utils_updateLatency(&linkStatsInfo->linkLatency,
+                        pSysBufferInput->linkLocalTimestamp);
+    Utils_updateLatency(&linkStatsInfo->srcToLinkLatency,
+                        pSysBufferInput->srcTimestamp);
+
+    linkStatsInfo->linkStats.chStats[channelId].inBufProcessCount++;
+
+    pCameraMirrorObj->tileFilledMask |= (1U << channelId);
+
+    if(pCameraMirrorObj->tileFilledMask == pCameraMirrorObj->tileValidMask)
+    {
+        AlgorithmLink_CameraMirrorMosaicEmit(pObj, pCameraMirrorObj);
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Hand the pending composite to the next link
+ *
+ *        Tiles of channels which did not arrive are cleared to black, the
+ *        recycled buffer would otherwise show an older frame of the channel.
+ *
+ * \param  pObj                [IN] Algorithm link object handle
+ * \param  pCameraMirrorObj    [IN] Camera mirror link object
+ *
+ * \return  SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 AlgorithmLink_CameraMirrorMosaicEmit(void * pObj,
+                     AlgorithmLink_CameraMirrorObj *pCameraMirrorObj)
+{
+    Int32                        status;
+    UInt32                       channelId;
+    UInt32                       planeIdx;
+    UInt32                       missingMask;
+    Alg_CameraMirrorPlan       * pPlan;
+    System_Buffer              * pSysBufferOutput;
+    System_VideoFrameBuffer    * pSysVideoFrameBufferOutput;
+
+    pSysBufferOutput           = pCameraMirrorObj->pCurOutBuf;
+    pSysVideoFrameBufferOutput = pSysBufferOutput->payload;
+
+    missingMask = pCameraMirrorObj->tileValidMask
+                    & ~(pCameraMirrorObj->tileFilledMask);
+
+    for(channelId = 0;
+        channelId < pCameraMirrorObj->numInputChannels;
+        channelId++)
+    {
+        if((missingMask & (1U << channelId)) == 0)
+        {
+            continue;
+        }
+
+        pPlan = &(pCameraMirrorObj->chPlan[channelId]);
+
+        Alg_CameraMirrorClearTile(pCameraMirrorObj->algHandle,
+                                  pPlan,
+                                  (UInt32 **)pSysVideoFrameBufferOutput->bufAddr
+                                 );
+
+        for(planeIdx = 0; planeIdx < pPlan->numPlanes; planeIdx++)
+        {
+            Cache_wb((UInt32 *)pSysVideoFrameBufferOutput->bufAddr[planeIdx]
+                        + pPlan->plane[planeIdx].dstOffset,
+                     pPlan->plane[planeIdx].dstCacheSize,
+                     Cache_Type_ALL,
+                     TRUE
+                    );
+        }
+
+        pCameraMirrorObj->numTilesCleared++;
+    }
+
+    pSysBufferOutput->srcTimestamp       =
+        pCameraMirrorObj->windowStartTimestamp;
+    pSysBufferOutput->linkLocalTimestamp = Utils_getCurGlobalTimeInUsec();
+
+    status = AlgorithmLink_putFullOutputBuffer(pObj,
+                                               0,
+                                               pSysBufferOutput);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+    /*
+     * The composite is the single output channel
+     */
+    pCameraMirrorObj->linkStatsInfo->linkStats.chStats[0].outBufCount[0]++;
+
+    System_sendLinkCmd(pCameraMirrorObj->outQueParams.nextLink,
+                       SYSTEM_CMD_NEW_DATA,
+                       NULL);
+
+    pCameraMirrorObj->pCurOutBuf = NULL;
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
 /**
  *******************************************************************************
  *
@@ -553,6 +1338,22 @@ Int32 AlgorithmLink_CameraMirrorPrintStatistics(void *pObj,
                         TRUE
                        );
 
+    if(pCameraMirrorObj->controlParams.enableLumaStats != FALSE)
+    {
+        Vps_printf(" ALG_CAMERAMIRROR: Frames without luma statistics = %d\n",
+                   pCameraMirrorObj->numStatsSkippedFrames);
+    }
+
+    if(pCameraMirrorObj->isMosaicMode == TRUE)
+    {
+        Vps_printf(" ALG_CAMERAMIRROR: Incomplete composites = %d\n",
+                   pCameraMirrorObj->numIncompleteComposites);
+        Vps_printf(" ALG_CAMERAMIRROR: Missing tiles cleared = %d\n",
+                   pCameraMirrorObj->numTilesCleared);
+        Vps_printf(" ALG_CAMERAMIRROR: Late frames dropped = %d\n",
+                   pCameraMirrorObj->numLateFrames);
+    }
+
     return SYSTEM_LINK_STATUS_SOK;
 }
 
@@ -11,6 +11,45 @@ extern "C" {
 #include "iCameraMirrorAlgo.h"
 #include <src/utils_common/include/utils_link_stats_if.h>
 #define FRAMECOPY_LINK_MAX_FRAMES (10)
+#define ALGORITHM_LINK_CAMERAMIRROR_CMD_SET_CONTROL_PARAMS (0x2001)
+/**< Control command to apply AlgorithmLink_CameraMirrorControlParams */
+typedef struct
+{
+ AlgorithmLink_ControlParams baseClassControl;
+ /**< Base class control params, controlCmd is
+ ALGORITHM_LINK_CAMERAMIRROR_CMD_SET_CONTROL_PARAMS */
+ Alg_CameraMirrorControlParams algControlParams;
+ /**< New algorithm control params, luma statistics get written to the
+ meta buffer of every output frame when enabled */
+} AlgorithmLink_CameraMirrorControlParams;
+typedef struct
+{
+ UInt32 enableMosaic;
+ /**< Write every channel into its tile of a composite output frame
+ instead of mirroring the input buffers in place */
+ UInt32 numTilesH;
+ /**< Number of tiles in horizontal direction, channel N goes to tile
+ (N % numTilesH, N / numTilesH) */
+ UInt32 numTilesV;
+ /**< Number of tiles in vertical direction */
+ UInt32 enableDecimation;
+ /**< Scale every channel down by 2 in both directions */
+ UInt32 windowUs;
+ /**< Max source timestamp distance in usec from the first tile of a
+ composite. A newer frame outside the window emits the current
+ composite with missing tiles, an older one is dropped as late.
+ 0 only emits early when a channel repeats */
+ UInt32 numOutBuffers;
+ /**< Number of composite buffers, max FRAMECOPY_LINK_MAX_FRAMES */
+} AlgorithmLink_CameraMirrorMosaicParams;
+typedef struct
+{
+ AlgorithmLink_CameraMirrorCreateParams baseCreateParams;
+ /**< Regular create params, baseClassCreate.size must be set to
+ sizeof(AlgorithmLink_CameraMirrorMosaicCreateParams) */
+ AlgorithmLink_CameraMirrorMosaicParams mosaicPrm;
+ /**< Mosaic mode parameters */
+} AlgorithmLink_CameraMirrorMosaicCreateParams;
 typedef struct
 {
  Alg_CameraMirror_Obj * algHandle;
@@ -23,6 +62,9 @@ typedef struct
  /**< Input channel information */
  UInt32 numInputChannels;
  /**< Number of input channels */
+ Alg_CameraMirrorPlan chPlan[SYSTEM_MAX_CH_PER_OUT_QUE];
+ /**< Per channel processing plan, built from inputChInfo at create time
+ and rebuilt on control */
  Alg_CameraMirrorCreateParams createParams;
  /**< Create params of the color to gray algorithm */
  Alg_CameraMirrorControlParams controlParams;
@@ -41,12 +83,60 @@ typedef struct
  /**< Flag to indicate if first frame is received, this is used as trigger
  * to start stats counting
  */
+ UInt32 numStatsSkippedFrames;
+ /**< Number of frames which got no luma statistics while enabled */
+ Bool isMosaicMode;
+ /**< TRUE when the link composes the channels into one output frame */
+ AlgorithmLink_CameraMirrorMosaicParams mosaicPrm;
+ /**< Mosaic mode parameters */
+ UInt32 tileWidth;
+ /**< Width of one tile of the composite */
+ UInt32 tileHeight;
+ /**< Height of one tile of the composite */
+ System_LinkChInfo outChInfo;
+ /**< Channel info of the composite */
+ UInt32 numOutPlanes;
+ /**< Number of planes of the composite */
+ UInt32 outBufSize[SYSTEM_MAX_PLANES];
+ /**< Size of every plane of the composite */
+ System_Buffer buffers[FRAMECOPY_LINK_MAX_FRAMES];
+ /**< System buffers of the composite frames */
+ System_VideoFrameBuffer videoFrames[FRAMECOPY_LINK_MAX_FRAMES];
+ /**< Payload of the composite frames */
+ System_Buffer *pCurOutBuf;
+ /**< Composite currently being filled, NULL if none */
+ UInt64 windowStartTimestamp;
+ /**< Source timestamp of the first tile of pCurOutBuf */
+ UInt32 tileFilledMask;
+ /**< Channels already written to pCurOutBuf */
+ UInt32 tileValidMask;
+ /**< Channels with a valid tile plan, a composite is complete once
+ tileFilledMask equals this */
+ UInt32 numIncompleteComposites;
+ /**< Number of composites emitted with missing tiles */
+ UInt32 numTilesCleared;
+ /**< Number of missing tiles cleared to black before emitting */
+ UInt32 numLateFrames;
+ /**< Number of frames dropped for being older than the window */
 } AlgorithmLink_CameraMirrorObj;
 Int32 AlgorithmLink_CameraMirrorCreate(void * pObj, void * pCreateParams);
 Int32 AlgorithmLink_CameraMirrorProcess(void * pObj);
 Int32 AlgorithmLink_CameraMirrorControl(void * pObj, void * pControlParams);
 Int32 AlgorithmLink_CameraMirrorStop(void * pObj);
 Int32 AlgorithmLink_CameraMirrorDelete(void * pObj);
+Int32 AlgorithmLink_CameraMirrorCreatePlans(
+ AlgorithmLink_CameraMirrorObj *pCameraMirrorObj);
+Int32 AlgorithmLink_CameraMirrorMosaicInit(
+ AlgorithmLink_CameraMirrorObj *pCameraMirrorObj);
+Int32 AlgorithmLink_CameraMirrorMosaicAllocBuffers(void * pObj,
+ AlgorithmLink_CameraMirrorObj *pCameraMirrorObj);
+Int32 AlgorithmLink_CameraMirrorMosaicFreeBuffers(
+ AlgorithmLink_CameraMirrorObj *pCameraMirrorObj);
+Int32 AlgorithmLink_CameraMirrorMosaicProcess(void * pObj,
+ AlgorithmLink_CameraMirrorObj *pCameraMirrorObj,
+ System_Buffer *pSysBufferInput);
+Int32 AlgorithmLink_CameraMirrorMosaicEmit(void * pObj,
+ AlgorithmLink_CameraMirrorObj *pCameraMirrorObj);
 Int32 AlgorithmLink_CameraMirrorPrintStatistics(void *pObj,
  AlgorithmLink_CameraMirrorObj *pCameraMirrorObj);
 #ifdef __cplusplus
@@ -4,9 +4,27 @@
 extern "C" {
 #endif
 #include <include/link_api/system.h>
+#define ALG_CAMERAMIRROR_HIST_BINS (256U)
+/**< Number of bins of the luma histogram */
+#define ALG_CAMERAMIRROR_MAX_BLK_H (16U)
+/**< Max number of luma statistics blocks in horizontal direction */
+#define ALG_CAMERAMIRROR_MAX_BLK_V (16U)
+/**< Max number of luma statistics blocks in vertical direction */
+#define ALG_CAMERAMIRROR_LUMA_STATS_MAGIC (0x314D4D43U)
+/**< Tag of Alg_CameraMirrorLumaStats, "CMM1", changes with the layout */
 typedef struct
 {
- UInt32 xxx;
+ UInt32 enableLumaStats;
+ /**< Gather luma histogram and block means while mirroring */
+ UInt32 numBlkH;
+ /**< Number of statistics blocks in horizontal direction */
+ UInt32 numBlkV;
+ /**< Number of statistics blocks in vertical direction */
+} Alg_CameraMirrorControlParams;
+typedef struct
+{
+ Alg_CameraMirrorControlParams controlParams;
+ /**< Currently applied control parameters */
 } Alg_CameraMirror_Obj;
 typedef struct
 {
@@ -14,18 +32,129 @@ typedef struct
 } Alg_CameraMirrorCreateParams;
 typedef struct
 {
- UInt32 xxx;
- /**< Any parameters which can be used to alter the algorithm behavior */
-} Alg_CameraMirrorControlParams;
+ UInt32 magic;
+ /**< Always ALG_CAMERAMIRROR_LUMA_STATS_MAGIC, lets consumers of the meta
+ * buffer identify the payload */
+ UInt32 width;
+ /**< Width of the frame the statistics were gathered on */
+ UInt32 height;
+ /**< Height of the frame the statistics were gathered on */
+ UInt32 numBlkH;
+ /**< Number of valid block columns in blkMean */
+ UInt32 numBlkV;
+ /**< Number of valid block rows in blkMean */
+ UInt32 lumaMean;
+ /**< Mean luma of the whole frame */
+ UInt32 hist[ALG_CAMERAMIRROR_HIST_BINS];
+ /**< Luma histogram */
+ UInt32 blkMean[ALG_CAMERAMIRROR_MAX_BLK_V * ALG_CAMERAMIRROR_MAX_BLK_H];
+ /**< Mean luma per block of the mirrored frame, row major with numBlkH
+ * entries per block row */
+} Alg_CameraMirrorLumaStats;
+typedef struct
+{
+ UInt32 wordWidth;
+ /**< Number of 32-bit words of active data in one row */
+ UInt32 wordPitch;
+ /**< Distance between two consecutive rows, in 32-bit words */
+ UInt32 numRowPairs;
+ /**< Number of top/bottom row pairs which get swapped */
+ UInt32 lastRowOffset;
+ /**< Offset of the last active row from the plane start, in 32-bit words */
+ UInt32 cacheSize;
+ /**< Number of bytes of the plane touched by the kernel, used for
+ * cache invalidate / write back */
+ UInt32 numOutRows;
+ /**< Tile plans: number of rows written to the output */
+ UInt32 srcRowStep;
+ /**< Tile plans: distance between two source rows read, in 32-bit words */
+ UInt32 dstOffset;
+ /**< Tile plans: offset of the tile in the output plane, in 32-bit words */
+ UInt32 dstWordPitch;
+ /**< Tile plans: output pitch, in 32-bit words */
+ UInt32 dstCacheSize;
+ /**< Tile plans: number of bytes written from dstOffset onwards */
+ UInt32 dstFillWord;
+ /**< Tile plans: black for the format of the plane, used to clear the
+ * tile when the channel is missing */
+} Alg_CameraMirrorPlaneInfo;
+typedef Void (*Alg_CameraMirrorKernelFxn)(
+ const Alg_CameraMirrorPlaneInfo *pPlane,
+ UInt32 *planePtr);
+typedef Void (*Alg_CameraMirrorCopyKernelFxn)(
+ const Alg_CameraMirrorPlaneInfo *pPlane,
+ const UInt32 *srcPtr,
+ UInt32 *dstPtr);
+typedef struct
+{
+ UInt32 numBlkH;
+ /**< Number of block columns */
+ UInt32 numBlkV;
+ /**< Number of block rows */
+ UInt32 numRows;
+ /**< Number of luma rows of the frame */
+ UInt32 pixPerWord;
+ /**< Number of luma samples in one 32-bit word */
+ UInt32 blkColEnd[ALG_CAMERAMIRROR_MAX_BLK_H];
+ /**< Word index one past the end of every block column */
+} Alg_CameraMirrorStatsGrid;
+typedef Void (*Alg_CameraMirrorStatsKernelFxn)(
+ const Alg_CameraMirrorPlaneInfo *pPlane,
+ const Alg_CameraMirrorStatsGrid *pGrid,
+ UInt32 *planePtr,
+ Alg_CameraMirrorLumaStats *pStats);
+typedef struct
+{
+ Alg_CameraMirrorKernelFxn kernelFxn;
+ /**< In place kernel run on every plane, NULL for tile plans or if the
+ * channel can not be processed */
+ Alg_CameraMirrorCopyKernelFxn copyKernelFxn[SYSTEM_MAX_PLANES];
+ /**< Tile plans: kernel writing the mirrored plane into its tile of the
+ * output, NULL for in place plans or if the channel can not be processed */
+ UInt32 numPlanes;
+ /**< Number of planes of the data format */
+ Alg_CameraMirrorPlaneInfo plane[SYSTEM_MAX_PLANES];
+ /**< Per plane geometry */
+ Alg_CameraMirrorStatsKernelFxn statsKernelFxn;
+ /**< Kernel run on the luma plane when statistics are requested,
+ * NULL if statistics are disabled for the channel */
+ Alg_CameraMirrorStatsGrid statsGrid;
+ /**< Block layout used by statsKernelFxn */
+} Alg_CameraMirrorPlan;
 Alg_CameraMirror_Obj * Alg_CameraMirrorCreate(
  Alg_CameraMirrorCreateParams *pCreateParams);
-Int32 Alg_CameraMirrorProcess(Alg_CameraMirror_Obj *algHandle,
- UInt32 *inPtr[],
-UInt32 width,
-UInt32 height,
+Int32 Alg_CameraMirrorPlanCreate(Alg_CameraMirror_Obj *algHandle,
+ Alg_CameraMirrorPlan *pPlan,
+ UInt32 width,
+ UInt32 height,
  UInt32 inPitch[],
  UInt32 dataFormat
  );
+Int32 Alg_CameraMirrorTilePlanCreate(Alg_CameraMirror_Obj *algHandle,
+ Alg_CameraMirrorPlan *pPlan,
+ UInt32 width,
+ UInt32 height,
+ UInt32 inPitch[],
+ UInt32 dataFormat,
+ UInt32 tileX,
+ UInt32 tileY,
+ UInt32 outPitch[],
+ Bool isDecimate
+ );
+Int32 Alg_CameraMirrorProcessTile(Alg_CameraMirror_Obj *algHandle,
+ const Alg_CameraMirrorPlan *pPlan,
+ UInt32 *inPtr[],
+ UInt32 *outPtr[]
+ );
+Int32 Alg_CameraMirrorClearTile(Alg_CameraMirror_Obj *algHandle,
+ const Alg_CameraMirrorPlan *pPlan,
+ UInt32 *outPtr[]
+ );
+Int32 Alg_CameraMirrorProcess(Alg_CameraMirror_Obj *algHandle,
+ const Alg_CameraMirrorPlan *pPlan,
+ UInt32 *inPtr[],
+ Alg_CameraMirrorLumaStats *pStats
+ );
 Int32 Alg_CameraMirrorControl(Alg_CameraMirror_Obj *pAlgHandle,Alg_CameraMirrorControlParams *pControlParams);
 Int32 Alg_CameraMirrorDelete(Alg_CameraMirror_Obj *pAlgHandle);
 #ifdef __cplusplus